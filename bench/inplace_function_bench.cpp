@@ -0,0 +1,214 @@
+#include <larid/inplace_function.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace {
+
+    constexpr unsigned default_iterations = 10'000'000;
+    constexpr unsigned repetitions        = 5;  ///< best of, alternating between the measured variants
+
+    /// Keep the optimizer from discarding or hoisting a value we want measured.
+    template<class T>
+    inline void do_not_optimize(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * Type-erased call using the previous invoker convention: the call operator takes every argument by value and
+     * the invoker receives them as Args&&. Kept here as the baseline the current inplace_function is compared to.
+     */
+    template<class Signature>
+    class legacy_function;
+
+    template<class R, class... Args>
+    class legacy_function<R(Args...)> {
+    public:
+        template<class C>
+        explicit legacy_function(C closure) : invoke_ptr_([](void* storage, Args&&... args) -> R {
+              return (*static_cast<C*>(storage))(static_cast<Args&&>(args)...);
+          }) {
+            static_assert(sizeof(C) <= sizeof(storage_));
+            ::new (static_cast<void*>(storage_)) C(std::move(closure));
+        }
+
+        R operator()(Args... args) const {
+            return invoke_ptr_(storage_, std::forward<Args>(args)...);
+        }
+
+    private:
+        R (*invoke_ptr_)(void*, Args&&...);
+        alignas(void*) mutable uint8_t storage_[sizeof(void*)];
+    };
+
+    template<class Fn>
+    double ns_per_call(unsigned iterations, Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+    }
+
+    template<class Fn>
+    double best_ns_per_call(unsigned iterations, Fn&& fn) {
+        double best = std::numeric_limits<double>::max();
+        for (unsigned r = 0; r < repetitions; ++r) {
+            best = std::min(best, ns_per_call(iterations, fn));
+        }
+        return best;
+    }
+
+    template<class Legacy, class Current, class Fn>
+    void compare(std::string_view name, unsigned iterations, Legacy const& legacy, Current const& current, Fn&& call) {
+        double legacy_ns  = std::numeric_limits<double>::max();
+        double current_ns = std::numeric_limits<double>::max();
+        for (unsigned r = 0; r < repetitions; ++r) {
+            legacy_ns  = std::min(legacy_ns, ns_per_call(iterations, [&](unsigned i) { call(legacy, i); }));
+            current_ns = std::min(current_ns, ns_per_call(iterations, [&](unsigned i) { call(current, i); }));
+        }
+        std::cout << std::format("{:<24} legacy {:8.3f} ns/call   current {:8.3f} ns/call   ({:+.1f}%)\n",
+                                 name,
+                                 legacy_ns,
+                                 current_ns,
+                                 100.0 * (current_ns - legacy_ns) / legacy_ns);
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const unsigned iterations = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : default_iterations;
+
+    {
+        auto fn = [](int a, unsigned b) { return a + static_cast<int>(b); };
+        legacy_function<int(int, unsigned)> legacy{fn};
+        larid::inplace_function<int(int, unsigned)> current{fn};
+        compare("scalar", iterations, legacy, current, [](auto const& f, unsigned i) {
+            do_not_optimize(f(static_cast<int>(i), i));
+        });
+    }
+
+    {
+        std::array<int, 64> data{};
+        std::iota(data.begin(), data.end(), 0);
+        auto fn = [](std::span<const int> s) { return s.size() + static_cast<size_t>(s.front()); };
+        legacy_function<size_t(std::span<const int>)> legacy{fn};
+        larid::inplace_function<size_t(std::span<const int>)> current{fn};
+        compare("std::span", iterations, legacy, current, [&](auto const& f, unsigned i) {
+            do_not_optimize(f(std::span<const int>(data).subspan(i % 8)));
+        });
+    }
+
+    {
+        // short enough for the small string buffer and taken by reference in the callee, so the cases measure the
+        // copies and moves made while passing the argument rather than allocation
+        const std::string text(15, 'x');
+        auto fn = [](const std::string& s) { return s.size(); };
+        legacy_function<size_t(std::string)> legacy{fn};
+        larid::inplace_function<size_t(std::string)> current{fn};
+        compare("std::string (lvalue)", iterations, legacy, current, [&](auto const& f, unsigned) {
+            do_not_optimize(f(text));
+        });
+        compare("std::string (prvalue)", iterations, legacy, current, [&](auto const& f, unsigned) {
+            do_not_optimize(f(std::string(text)));
+        });
+
+        // moving an existing string into a callee that takes it by value
+        auto sink = [](std::string s) { return s.size(); };
+        legacy_function<size_t(std::string)> legacy_sink{sink};
+        larid::inplace_function<size_t(std::string)> current_sink{sink};
+        compare("std::string (xvalue)", iterations, legacy_sink, current_sink, [&](auto const& f, unsigned) {
+            std::string s = text;
+            do_not_optimize(f(std::move(s)));
+        });
+    }
+
+    {
+        // a handler with three entry points over the same state, stored as separate functions and as one overload
+        struct state_t {
+            size_t bytes;
+            unsigned timeouts;
+            int last_error;
+        };
+        struct split_handler {
+            larid::inplace_function<void(std::span<const int>), sizeof(state_t*)> on_data;
+            larid::inplace_function<void(unsigned), sizeof(state_t*)> on_timeout;
+            larid::inplace_function<void(int), sizeof(state_t*)> on_error;
+        };
+        using overload_handler = larid::basic_inplace_overload<sizeof(state_t*),
+                                                               alignof(state_t*),
+                                                               void(std::span<const int>),
+                                                               void(unsigned),
+                                                               void(int)>;
+
+        state_t state{};
+        split_handler split{[s = &state](std::span<const int> d) { s->bytes += d.size(); },
+                            [s = &state](unsigned t) { s->timeouts += t; },
+                            [s = &state](int e) { s->last_error = e; }};
+        struct state_ref {
+            state_t* s;
+            void operator()(std::span<const int> d) const { s->bytes += d.size(); }
+            void operator()(unsigned t) const { s->timeouts += t; }
+            void operator()(int e) const { s->last_error = e; }
+        };
+        overload_handler combined{state_ref{&state}};
+
+        std::cout << std::format("handler size: 3x inplace_function {} bytes, inplace_overload {} bytes\n",
+                                 sizeof(split_handler),
+                                 sizeof(overload_handler));
+        const auto compare_handlers = [&](std::string_view entry, auto&& call_split, auto&& call_combined) {
+            const double split_ns    = best_ns_per_call(iterations, call_split);
+            const double combined_ns = best_ns_per_call(iterations, call_combined);
+            std::cout << std::format("handler {}: 3x inplace_function {:.3f} ns, inplace_overload {:.3f} ns\n",
+                                     entry,
+                                     split_ns,
+                                     combined_ns);
+        };
+
+        std::array<int, 16> data{};
+        compare_handlers(
+            "on_data",
+            [&](unsigned i) { split.on_data(std::span<const int>(data).subspan(i % 8)); },
+            [&](unsigned i) { combined(std::span<const int>(data).subspan(i % 8)); });
+        compare_handlers(
+            "on_timeout",
+            [&](unsigned i) { split.on_timeout(i); },
+            [&](unsigned i) { combined(i); });
+        compare_handlers(
+            "on_error",
+            [&](unsigned i) { split.on_error(static_cast<int>(i)); },
+            [&](unsigned i) { combined(static_cast<int>(i)); });
+        do_not_optimize(state);
+
+        compare_handlers(
+            "relocate",
+            [&](unsigned) {
+                split_handler moved{std::move(split)};
+                split = std::move(moved);
+                do_not_optimize(split);
+            },
+            [&](unsigned) {
+                overload_handler moved{std::move(combined)};
+                combined = std::move(moved);
+                do_not_optimize(combined);
+            });
+    }
+
+    return 0;
+}
+
+extern "C" {
+void vAssertCalled(const char* file, int line) {
+    std::cerr << std::format("\n[CRITICAL] OS Assert called: {}, line {}\n", file, line);
+    std::terminate();
+}
+}  // extern "C"
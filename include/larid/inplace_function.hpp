@@ -30,13 +30,20 @@
 *  - constexpr constructors
 *  - change default size to sizeof(void*)
 *  - replace the exception thrown when using an empty function with a larid_Assert
+*  - calling an empty function aborts after the assert instead of returning from a non-void invoker
 *  - formatting, rearrange special member functions to group by type
+*  - invoker takes small trivially copyable arguments by value and forwards everything else without a copy;
+*    operator() takes the invoker's parameter types (rvalues, braced lists and null pointer constants bind directly)
+*    plus a fallback template that copies lvalues once, so a call mixing an lvalue with a braced list for a
+*    non-trivially copyable by-value parameter, e.g. f(str, {}), no longer compiles
+*  - add inplace_overload, one closure callable through several signatures behind a single vtable
 */
 #pragma once
 
 #include <type_traits>
 #include <utility>
 #include <functional>
+#include <cstdlib>
 #include <FreeRTOS.h>
 
 
@@ -102,6 +109,52 @@ namespace larid {
        using is_invocable_r = is_invocable_r_impl<void, R, F, Args...>;
 
 
+       /**
+        * Parameter type used by the type-erased invoker for a signature argument of type T.
+        * Trivially copyable values that fit in a register pair are passed by value so they stay in registers,
+        * references keep their own category, and every other value type is passed as T&& so the caller's
+        * argument is forwarded straight through to the stored callable without an intermediate copy.
+        */
+       template<class T>
+       using invoke_arg_t = std::conditional_t<!std::is_reference_v<T> && std::is_trivially_copyable_v<T>
+                                                   && sizeof(T) <= 2 * sizeof(void*),
+                                               T,
+                                               T&&>;
+
+       /**
+        * Hands an argument of the call operator's fallback overload to the invoker. Arguments the invoker takes as T&&
+        * are moved through when the caller passed an rvalue T; lvalues and other types are materialized once as a T.
+        */
+       template<class Arg, class T>
+       constexpr decltype(auto) forward_arg(T&& arg) {
+           using value_t = std::remove_cv_t<Arg>;
+           if constexpr (std::is_reference_v<Arg> || !std::is_reference_v<invoke_arg_t<Arg>>) {
+               return static_cast<T&&>(arg);
+           }
+           else if constexpr (std::is_same_v<T, value_t>) {
+               return static_cast<value_t&&>(arg);
+           }
+           else {
+               return value_t(static_cast<T&&>(arg));
+           }
+       }
+
+       template<class... Ts>
+       struct type_list {};
+
+       /**
+        * True when a call with argument types Ts can be forwarded to a signature taking Args, i.e. the counts match
+        * and each argument converts implicitly to the corresponding parameter type.
+        */
+       template<class TsList, class ArgsList, class = void>
+       struct is_forwardable_args : std::false_type {};
+
+       template<class... Ts, class... Args>
+       struct is_forwardable_args<type_list<Ts...>,
+                                  type_list<Args...>,
+                                  std::enable_if_t<sizeof...(Ts) == sizeof...(Args)>>
+           : std::conjunction<std::is_convertible<Ts, Args>...> {};
+
        template<size_t DstCap, size_t DstAlign, size_t SrcCap, size_t SrcAlign>
        struct is_valid_inplace_dst : std::true_type {
            static_assert(DstCap >= SrcCap, "Can't squeeze larger inplace_function into a smaller one");
@@ -112,7 +165,7 @@ namespace larid {
        struct vtable {
            using storage_ptr_t = void*;
 
-           using invoke_ptr_t = R (*)(storage_ptr_t, Args&&...);
+           using invoke_ptr_t = R (*)(storage_ptr_t, invoke_arg_t<Args>...);
            using process_ptr_t = void (*)(storage_ptr_t, storage_ptr_t);
            using destructor_ptr_t = void (*)(storage_ptr_t);
 
@@ -122,21 +175,20 @@ namespace larid {
            const destructor_ptr_t destructor_ptr;
 
            // clang-format off
-           #pragma warning(disable:4716)
            constexpr explicit vtable() noexcept
-               : invoke_ptr([](storage_ptr_t, Args&&...) -> R {
+               : invoke_ptr([](storage_ptr_t, invoke_arg_t<Args>...) -> R {
                      configASSERT(false);
+                     std::abort();
                  }),
                  copy_ptr([](storage_ptr_t, storage_ptr_t){}),
                  relocate_ptr([](storage_ptr_t, storage_ptr_t){}),
                  destructor_ptr([](storage_ptr_t){})
            {}
-           #pragma warning(default:4716)
 
            template<class C>
            constexpr explicit vtable(wrapper<C>) noexcept
-               : invoke_ptr([](storage_ptr_t storage_ptr, Args&&... args) -> R {
-                     return (*static_cast<C*>(storage_ptr))(static_cast<Args&&>(args)...);
+               : invoke_ptr([](storage_ptr_t storage_ptr, invoke_arg_t<Args>... args) -> R {
+                     return (*static_cast<C*>(storage_ptr))(static_cast<invoke_arg_t<Args>&&>(args)...);
                  }),
                  copy_ptr([](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void {
                      ::new (dst_ptr) C((*static_cast<C*>(src_ptr)));
@@ -163,7 +215,7 @@ namespace larid {
        struct unique_vtable {
            using storage_ptr_t = void*;
 
-           using invoke_ptr_t = R (*)(storage_ptr_t, Args&&...);
+           using invoke_ptr_t = R (*)(storage_ptr_t, invoke_arg_t<Args>...);
            using process_ptr_t = void (*)(storage_ptr_t, storage_ptr_t);
            using destructor_ptr_t = void (*)(storage_ptr_t);
 
@@ -172,20 +224,19 @@ namespace larid {
            const destructor_ptr_t destructor_ptr;
 
            // clang-format off
-           #pragma warning(disable:4716)
            constexpr explicit unique_vtable() noexcept
-               : invoke_ptr{[](storage_ptr_t, Args&&...) -> R {
+               : invoke_ptr{[](storage_ptr_t, invoke_arg_t<Args>...) -> R {
                      configASSERT(false);
+                     std::abort();
                  }},
                  relocate_ptr{[](storage_ptr_t, storage_ptr_t){}},
                  destructor_ptr{[](storage_ptr_t){}}
            {}
-           #pragma warning(default:4716)
 
            template<class C>
            constexpr explicit unique_vtable(inplace_function_detail::wrapper<C>) noexcept
-               : invoke_ptr{[](storage_ptr_t storage_ptr, Args&&... args) -> R {
-                     return (*static_cast<C*>(storage_ptr))(static_cast<Args&&>(args)...);
+               : invoke_ptr{[](storage_ptr_t storage_ptr, invoke_arg_t<Args>... args) -> R {
+                     return (*static_cast<C*>(storage_ptr))(static_cast<invoke_arg_t<Args>&&>(args)...);
                  }},
                  relocate_ptr{[](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void {
                      ::new (dst_ptr) C(std::move(*static_cast<C*>(src_ptr)));
@@ -205,6 +256,150 @@ namespace larid {
        template<class R, class... Args>
        constexpr unique_vtable<R, Args...> empty_unique_vtable{};
 
+       template<class Sig>
+       struct overload_invoker;  // unspecified
+
+       template<class R, class... Args>
+       struct overload_invoker<R(Args...)> {
+           using storage_ptr_t = void*;
+
+           using result_type = R;
+           using invoke_ptr_t = R (*)(storage_ptr_t, invoke_arg_t<Args>...);
+
+           const invoke_ptr_t invoke_ptr;
+
+           // clang-format off
+           constexpr explicit overload_invoker() noexcept
+               : invoke_ptr{[](storage_ptr_t, invoke_arg_t<Args>...) -> R {
+                     configASSERT(false);
+                     std::abort();
+                 }}
+           {}
+
+           template<class C>
+           constexpr explicit overload_invoker(wrapper<C>) noexcept
+               : invoke_ptr{[](storage_ptr_t storage_ptr, invoke_arg_t<Args>... args) -> R {
+                     if constexpr (std::is_void_v<R>) {
+                         (*static_cast<C*>(storage_ptr))(static_cast<invoke_arg_t<Args>&&>(args)...);
+                     }
+                     else {
+                         return (*static_cast<C*>(storage_ptr))(static_cast<invoke_arg_t<Args>&&>(args)...);
+                     }
+                 }}
+           {}
+           // clang-format on
+       };
+
+       /**
+        * One table for every signature of an inplace_overload: an invoker per signature followed by a single set of
+        * copy/relocate/destroy entries for the shared closure.
+        */
+       template<class... Sigs>
+       struct overload_vtable : overload_invoker<Sigs>... {
+           using storage_ptr_t = void*;
+
+           using process_ptr_t = void (*)(storage_ptr_t, storage_ptr_t);
+           using destructor_ptr_t = void (*)(storage_ptr_t);
+
+           const process_ptr_t copy_ptr;
+           const process_ptr_t relocate_ptr;
+           const destructor_ptr_t destructor_ptr;
+
+           // clang-format off
+           constexpr explicit overload_vtable() noexcept
+               : overload_invoker<Sigs>()...,
+                 copy_ptr([](storage_ptr_t, storage_ptr_t){}),
+                 relocate_ptr([](storage_ptr_t, storage_ptr_t){}),
+                 destructor_ptr([](storage_ptr_t){})
+           {}
+
+           template<class C>
+           constexpr explicit overload_vtable(wrapper<C> w) noexcept
+               : overload_invoker<Sigs>(w)...,
+                 copy_ptr([](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void {
+                     ::new (dst_ptr) C((*static_cast<C*>(src_ptr)));
+                 }),
+                 relocate_ptr([](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void {
+                     ::new (dst_ptr) C(std::move(*static_cast<C*>(src_ptr)));
+                     static_cast<C*>(src_ptr)->~C();
+                 }),
+                 destructor_ptr([](storage_ptr_t src_ptr){ static_cast<C*>(src_ptr)->~C(); })
+           {}
+           // clang-format on
+
+           ~overload_vtable() = default;
+           overload_vtable(const overload_vtable&) = delete;
+           overload_vtable(overload_vtable&&) = delete;
+           overload_vtable& operator=(const overload_vtable&) = delete;
+           overload_vtable& operator=(overload_vtable&&) = delete;
+       };
+
+       template<class... Sigs>
+       inline constexpr overload_vtable<Sigs...> empty_overload_vtable{};
+
+       template<class C, class Sig>
+       struct is_invocable_as : std::false_type {};
+
+       template<class C, class R, class... Args>
+       struct is_invocable_as<C, R(Args...)> : std::is_invocable_r<R, C, Args...> {};
+
+       template<class Sig>
+       struct parameter_list;  // unspecified
+
+       template<class R, class... Args>
+       struct parameter_list<R(Args...)> {
+           using type = type_list<Args...>;
+       };
+
+       template<class...>
+       struct are_distinct : std::true_type {};
+
+       template<class T, class... Ts>
+       struct are_distinct<T, Ts...>
+           : std::bool_constant<(!std::is_same_v<T, Ts> && ...) && are_distinct<Ts...>::value> {};
+
+       template<class... Sigs>
+       using has_distinct_parameter_lists = are_distinct<typename parameter_list<Sigs>::type...>;
+
+       /**
+        * Supplies the call operators of an inplace_overload, one level per signature in a single chain of bases so the
+        * overload carries one empty base on every compiler (MSVC only folds the first of several empty bases). Each
+        * operator() takes the invoker's parameter types; select() declares the same signatures with by-value
+        * parameters so the fallback template in basic_inplace_overload resolves lvalues like a plain overload set.
+        */
+       template<class Derived, class... Sigs>
+       struct overload_call;  // unspecified
+
+       template<class Derived, class R, class... Args>
+       struct overload_call<Derived, R(Args...)> {
+           constexpr R operator()(invoke_arg_t<Args>... args) const {
+               const auto& self = static_cast<const Derived&>(*this);
+               const auto& invoker = static_cast<const overload_invoker<R(Args...)>&>(*self.vtable_ptr_);
+               return invoker.invoke_ptr(std::addressof(self.storage_), static_cast<invoke_arg_t<Args>&&>(args)...);
+           }
+
+           static const overload_invoker<R(Args...)>* select(Args...);
+       };
+
+       template<class Derived, class R, class... Args, class Next, class... Rest>
+       struct overload_call<Derived, R(Args...), Next, Rest...> : overload_call<Derived, Next, Rest...> {
+           using overload_call<Derived, Next, Rest...>::operator();
+           using overload_call<Derived, Next, Rest...>::select;
+
+           constexpr R operator()(invoke_arg_t<Args>... args) const {
+               const auto& self = static_cast<const Derived&>(*this);
+               const auto& invoker = static_cast<const overload_invoker<R(Args...)>&>(*self.vtable_ptr_);
+               return invoker.invoke_ptr(std::addressof(self.storage_), static_cast<invoke_arg_t<Args>&&>(args)...);
+           }
+
+           static const overload_invoker<R(Args...)>* select(Args...);
+       };
+
+       template<class R, class... Args, class... Ts>
+       constexpr R invoke_selected(const overload_invoker<R(Args...)>& invoker, void* storage_ptr, Ts&&... args) {
+           return invoker.invoke_ptr(storage_ptr, forward_arg<Args>(std::forward<Ts>(args))...);
+       }
+
    }  // namespace inplace_function_detail
 
    template<class Signature,
@@ -217,6 +412,16 @@ namespace larid {
             size_t Alignment = alignof(inplace_function_detail::aligned_storage_helper<Capacity>)>
    class unique_inplace_function;  // unspecified
 
+   template<size_t Capacity, size_t Alignment, class... Sigs>
+   class basic_inplace_overload;
+
+   template<class... Sigs>
+   using inplace_overload =
+       basic_inplace_overload<inplace_function_detail::InplaceFunctionDefaultCapacity,
+                              alignof(inplace_function_detail::aligned_storage_helper<
+                                      inplace_function_detail::InplaceFunctionDefaultCapacity>),
+                              Sigs...>;
+
    namespace inplace_function_detail {
 
        template<class Sig, size_t Cap, size_t Align>
@@ -225,6 +430,12 @@ namespace larid {
        template<class Sig, size_t Cap, size_t Align>
        struct is_inplace_function<unique_inplace_function<Sig, Cap, Align>> : std::true_type {};
 
+       template<class>
+       struct is_inplace_overload : std::false_type {};
+
+       template<size_t Cap, size_t Align, class... Sigs>
+       struct is_inplace_overload<basic_inplace_overload<Cap, Align, Sigs...>> : std::true_type {};
+
    }  // namespace inplace_function_detail
 
    template<class R, class... Args, size_t Capacity, size_t Alignment>
@@ -310,8 +521,18 @@ namespace larid {
            return *this;
        }
 
-       constexpr R operator()(Args... args) const {
-           return vtable_ptr_->invoke_ptr(std::addressof(storage_), std::forward<Args>(args)...);
+       constexpr R operator()(inplace_function_detail::invoke_arg_t<Args>... args) const {
+           return vtable_ptr_->invoke_ptr(std::addressof(storage_),
+                                          static_cast<inplace_function_detail::invoke_arg_t<Args>&&>(args)...);
+       }
+
+       template<class... Ts,
+                class = std::enable_if_t<inplace_function_detail::is_forwardable_args<
+                    inplace_function_detail::type_list<Ts&&...>,
+                    inplace_function_detail::type_list<Args...>>::value>>
+       constexpr R operator()(Ts&&... args) const {
+           return vtable_ptr_->invoke_ptr(std::addressof(storage_),
+                                          inplace_function_detail::forward_arg<Args>(std::forward<Ts>(args))...);
        }
 
        constexpr bool operator==(std::nullptr_t) const noexcept {
@@ -425,8 +646,18 @@ namespace larid {
            return *this;
        }
 
-       constexpr R operator()(Args... args) const {
-           return vtable_ptr_->invoke_ptr(std::addressof(storage_), std::forward<Args>(args)...);
+       constexpr R operator()(inplace_function_detail::invoke_arg_t<Args>... args) const {
+           return vtable_ptr_->invoke_ptr(std::addressof(storage_),
+                                          static_cast<inplace_function_detail::invoke_arg_t<Args>&&>(args)...);
+       }
+
+       template<class... Ts,
+                class = std::enable_if_t<inplace_function_detail::is_forwardable_args<
+                    inplace_function_detail::type_list<Ts&&...>,
+                    inplace_function_detail::type_list<Args...>>::value>>
+       constexpr R operator()(Ts&&... args) const {
+           return vtable_ptr_->invoke_ptr(std::addressof(storage_),
+                                          inplace_function_detail::forward_arg<Args>(std::forward<Ts>(args))...);
        }
 
        constexpr bool operator==(std::nullptr_t) const noexcept {
@@ -469,4 +700,141 @@ namespace larid {
        }
    };
 
+   /**
+    * A single inline-stored closure callable through several signatures. Every signature gets its own invoker in one
+    * shared vtable, so a handler with N entry points carries one vtable pointer and one copy of its captures instead
+    * of N inplace_functions. The closure must be invocable as every signature, and the signatures must have distinct
+    * parameter lists so operator() resolves like a normal overload set. Arguments are passed exactly as for
+    * inplace_function. The captures are shared when the closure is one object with several call operators; an
+    * overloaded{} of capturing lambdas still stores each lambda's captures.
+    */
+   template<size_t Capacity, size_t Alignment, class... Sigs>
+   class basic_inplace_overload
+       : public inplace_function_detail::overload_call<basic_inplace_overload<Capacity, Alignment, Sigs...>, Sigs...> {
+       static_assert(sizeof...(Sigs) > 0, "inplace_overload needs at least one signature");
+       static_assert(inplace_function_detail::has_distinct_parameter_lists<Sigs...>::value,
+                     "inplace_overload signatures must have distinct parameter lists");
+
+       using vtable_t = inplace_function_detail::overload_vtable<Sigs...>;
+       using vtable_ptr_t = const vtable_t*;
+       using call_base_t = inplace_function_detail::overload_call<basic_inplace_overload, Sigs...>;
+
+       template<class, class...>
+       friend struct inplace_function_detail::overload_call;
+
+   public:
+       using capacity = std::integral_constant<size_t, Capacity>;
+       using alignment = std::integral_constant<size_t, Alignment>;
+
+       using call_base_t::operator();
+
+       template<class... Ts,
+                class Selected = decltype(call_base_t::select(std::declval<Ts>()...)),
+                class Invoker = std::remove_cv_t<std::remove_pointer_t<Selected>>>
+       constexpr typename Invoker::result_type operator()(Ts&&... args) const {
+           return inplace_function_detail::invoke_selected(static_cast<const Invoker&>(*vtable_ptr_),
+                                                           std::addressof(storage_),
+                                                           std::forward<Ts>(args)...);
+       }
+
+       constexpr basic_inplace_overload() noexcept
+           : vtable_ptr_(std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>)),
+             storage_()
+       {}
+
+       constexpr ~basic_inplace_overload() {
+           static_assert(sizeof(basic_inplace_overload) == sizeof(inplace_function<void(), Capacity, Alignment>),
+                         "inplace_overload must be laid out like a single inplace_function");
+           vtable_ptr_->destructor_ptr(std::addressof(storage_));
+       }
+
+       constexpr basic_inplace_overload(std::nullptr_t) noexcept
+           : vtable_ptr_(std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>)) {}
+
+       template<class T,
+                class C = std::decay_t<T>,
+                class = std::enable_if_t<!inplace_function_detail::is_inplace_overload<C>::value
+                                         && (inplace_function_detail::is_invocable_as<C&, Sigs>::value && ...)>>
+       basic_inplace_overload(T&& closure) {
+           // clang-format off
+           static_assert(std::is_copy_constructible_v<C>, "inplace_overload cannot be constructed from non-copyable type");
+           static_assert(sizeof(C) <= Capacity, "inplace_overload cannot be constructed from object with this (large) size");
+           static_assert(Alignment % alignof(C) == 0, "inplace_overload cannot be constructed from object with this (large) alignment");
+           // clang-format on
+
+           static const vtable_t vt{inplace_function_detail::wrapper<C>{}};
+           vtable_ptr_ = std::addressof(vt);
+
+           ::new (std::addressof(storage_)) C(std::forward<T>(closure));
+       }
+
+       // clang-format off
+       constexpr basic_inplace_overload(basic_inplace_overload&& other) noexcept
+           : vtable_ptr_(std::exchange(other.vtable_ptr_, std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>)))
+       {
+           vtable_ptr_->relocate_ptr(std::addressof(storage_), std::addressof(other.storage_));
+       }
+
+       constexpr basic_inplace_overload(const basic_inplace_overload& other) : vtable_ptr_(other.vtable_ptr_) {
+           vtable_ptr_->copy_ptr(std::addressof(storage_), std::addressof(other.storage_));
+       }
+       // clang-format on
+
+       constexpr basic_inplace_overload& operator=(std::nullptr_t) noexcept {
+           vtable_ptr_->destructor_ptr(std::addressof(storage_));
+           vtable_ptr_ = std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>);
+           return *this;
+       }
+
+       constexpr basic_inplace_overload& operator=(basic_inplace_overload other) noexcept {
+           vtable_ptr_->destructor_ptr(std::addressof(storage_));
+
+           vtable_ptr_ = std::exchange(other.vtable_ptr_,
+                                       std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>));
+           vtable_ptr_->relocate_ptr(std::addressof(storage_), std::addressof(other.storage_));
+           return *this;
+       }
+
+       constexpr bool operator==(std::nullptr_t) const noexcept {
+           return !operator bool();
+       }
+
+       constexpr bool operator!=(std::nullptr_t) const noexcept {
+           return operator bool();
+       }
+
+       constexpr explicit operator bool() const noexcept {
+           return vtable_ptr_ != std::addressof(inplace_function_detail::empty_overload_vtable<Sigs...>);
+       }
+
+       void swap(basic_inplace_overload& other) noexcept {
+           if (this == std::addressof(other)) {
+               return;
+           }
+
+           alignas(Alignment) uint8_t tmp[Capacity];
+           vtable_ptr_->relocate_ptr(std::addressof(tmp), std::addressof(storage_));
+           other.vtable_ptr_->relocate_ptr(std::addressof(storage_), std::addressof(other.storage_));
+           vtable_ptr_->relocate_ptr(std::addressof(other.storage_), std::addressof(tmp));
+           std::swap(vtable_ptr_, other.vtable_ptr_);
+       }
+
+       friend void swap(basic_inplace_overload& lhs, basic_inplace_overload& rhs) noexcept {
+           lhs.swap(rhs);
+       }
+
+   private:
+       vtable_ptr_t vtable_ptr_;
+       alignas(Alignment) mutable uint8_t storage_[Capacity];
+   };
+
+   /// Combines several lambdas into one closure with an overloaded call operator, e.g. for an inplace_overload.
+   template<class... Fs>
+   struct overloaded : Fs... {
+       using Fs::operator()...;
+   };
+
+   template<class... Fs>
+   overloaded(Fs...) -> overloaded<Fs...>;
+
 }  // namespace larid
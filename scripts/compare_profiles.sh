@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+# Build the sanitize and performance (LTO + PGO) profiles side by side, run inplace_function_bench in both and report
+# how much slower each case is under the sanitizer build: the argument passing cases plus the handler dispatch and
+# relocate cases.
+#
+# usage: scripts/compare_profiles.sh [build-root] [iterations]
+set -euo pipefail
+
+source_dir="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+build_root="${1:-${source_dir}/build-profiles}"
+iterations="${2:-10000000}"
+jobs="$(nproc 2>/dev/null || echo 4)"
+
+sanitize_dir="${build_root}/sanitize"
+perf_dir="${build_root}/performance"
+
+echo "== sanitize build"
+cmake -S "${source_dir}" -B "${sanitize_dir}" -DLARID_BUILD_PROFILE=sanitize
+cmake --build "${sanitize_dir}" -j"${jobs}" --target inplace_function_bench
+
+echo "== performance build: PGO training"
+cmake -S "${source_dir}" -B "${perf_dir}" -DLARID_BUILD_PROFILE=performance -DLARID_PGO=GENERATE
+cmake --build "${perf_dir}" -j"${jobs}" --target pgo_train
+
+echo "== performance build: PGO optimized"
+cmake -S "${source_dir}" -B "${perf_dir}" -DLARID_BUILD_PROFILE=performance -DLARID_PGO=USE
+cmake --build "${perf_dir}" -j"${jobs}" --target inplace_function_bench
+
+# the sanitizer build should not abort the comparison on leak reports from the C++ runtime
+ASAN_OPTIONS="${ASAN_OPTIONS:-detect_leaks=0}" \
+    "${sanitize_dir}/inplace_function_bench" "${iterations}" > "${build_root}/sanitize.txt"
+"${perf_dir}/inplace_function_bench" "${iterations}" > "${build_root}/performance.txt"
+
+# Turn bench output into "<case>\t<ns>" rows. Argument passing lines look like
+#   "<name padded to 24> legacy <ns> ns/call   current <ns> ns/call   (<delta>)"  -> the current column
+# and handler lines like
+#   "handler <entry>: 3x inplace_function <ns> ns, inplace_overload <ns> ns"       -> one row per storage
+extract() {
+    awk '
+        / legacy / {
+            name = substr($0, 1, 24); sub(/ +$/, "", name)
+            split(substr($0, 25), f, " ")
+            printf "%s\t%s\n", name, f[5]
+            next
+        }
+        $1 == "handler" && $6 == "ns," {
+            entry = $2; sub(/:$/, "", entry)
+            printf "handler %s (split)\t%s\n", entry, $5
+            printf "handler %s (overload)\t%s\n", entry, $8
+        }' "$1"
+}
+
+echo
+printf '%-32s %14s %14s %10s\n' "case" "sanitize ns" "performance ns" "overhead"
+paste <(extract "${build_root}/sanitize.txt") <(extract "${build_root}/performance.txt") | awk -F '\t' '
+    { printf "%-32s %14.3f %14.3f %9.1fx\n", $1, $2, $4, $2 / $4 }'
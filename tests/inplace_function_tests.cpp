@@ -0,0 +1,150 @@
+#include <larid/inplace_function.hpp>
+#include <snitch/snitch.hpp>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+    struct counted {
+        static inline int copies = 0;
+        static inline int moves  = 0;
+
+        counted() = default;
+        counted(const counted&) { ++copies; }
+        counted(counted&&) noexcept { ++moves; }
+        counted& operator=(const counted&) = default;
+        counted& operator=(counted&&) noexcept = default;
+        ~counted() = default;
+
+        static void reset() {
+            copies = 0;
+            moves  = 0;
+        }
+    };
+
+    /// One closure object serving every entry point of a handler, sharing a single capture.
+    struct handler_closure {
+        int* state;
+        int operator()(int value) const { return *state += value; }
+        size_t operator()(const std::string& text) const { return text.size() + static_cast<size_t>(*state); }
+        bool operator()() const { return *state > 0; }
+    };
+
+    using handler_t = larid::basic_inplace_overload<32,
+                                                    alignof(void*),
+                                                    int(int),
+                                                    size_t(const std::string&),
+                                                    bool()>;
+
+    // one vtable pointer and the inline storage, no matter how many signatures
+    static_assert(sizeof(larid::inplace_overload<void(int), void(double), void(long)>)
+                  == sizeof(void*) + larid::inplace_function_detail::InplaceFunctionDefaultCapacity);
+    static_assert(sizeof(handler_t) == sizeof(void*) + 32);
+
+    // signatures are told apart by their parameter lists, not their return types
+    static_assert(larid::inplace_function_detail::has_distinct_parameter_lists<int(int), void(double)>::value);
+    static_assert(!larid::inplace_function_detail::has_distinct_parameter_lists<int(int), void(int)>::value);
+    static_assert(!larid::inplace_function_detail::has_distinct_parameter_lists<void(), bool()>::value);
+
+    // the call operators form one overload set
+    static_assert(std::is_invocable_r_v<int, const handler_t&, int>);
+    static_assert(std::is_invocable_r_v<size_t, const handler_t&, const char*>);
+    static_assert(std::is_invocable_r_v<size_t, const handler_t&, std::string&>);
+    static_assert(std::is_invocable_r_v<bool, const handler_t&>);
+    static_assert(!std::is_invocable_v<const handler_t&, int, int>);
+    static_assert(!std::is_invocable_v<const handler_t&, void*>);
+
+    // a closure has to cover every signature, and an overload is itself a closure for each of its signatures
+    static_assert(std::is_constructible_v<handler_t, handler_closure>);
+    static_assert(!std::is_constructible_v<handler_t, int (*)(int)>);
+    static_assert(std::is_constructible_v<larid::inplace_function<int(int), 40>, const handler_t&>);
+
+}  // namespace
+
+TEST_CASE("inplace_overload dispatches each signature to its call operator", "[inplace_overload]") {
+    int state = 0;
+    handler_t handler{handler_closure{&state}};
+    REQUIRE(static_cast<bool>(handler));
+
+    CHECK_FALSE(handler());
+    CHECK(handler(5) == 5);
+    CHECK(handler());
+    CHECK(handler(std::string("abc")) == 8U);
+    CHECK(handler("a") == 6U);
+    CHECK(state == 5);
+}
+
+TEST_CASE("inplace_overload built from overloaded lambdas", "[inplace_overload]") {
+    larid::inplace_overload<int(int), int(double), void(const char*)> o =
+        larid::overloaded{[](int) { return 1; }, [](double) { return 2; }, [](const char*) { return 3; }};
+
+    CHECK(o(1) == 1);
+    CHECK(o(1.0) == 2);
+    o("discarded result");
+}
+
+TEST_CASE("inplace_overload copy, move, swap and reset", "[inplace_overload]") {
+    int state = 1;
+    handler_t handler{handler_closure{&state}};
+
+    handler_t copy = handler;
+    REQUIRE(static_cast<bool>(copy));
+    CHECK(copy(1) == 2);
+    CHECK(handler(1) == 3);
+
+    handler_t moved = std::move(copy);
+    CHECK_FALSE(static_cast<bool>(copy));
+    REQUIRE(static_cast<bool>(moved));
+    CHECK(moved(1) == 4);
+
+    handler_t empty;
+    CHECK((empty == nullptr));
+    swap(empty, moved);
+    CHECK((empty != nullptr));
+    CHECK((moved == nullptr));
+    CHECK(empty(1) == 5);
+
+    empty = nullptr;
+    CHECK_FALSE(static_cast<bool>(empty));
+
+    moved = handler;
+    CHECK(moved(1) == 6);
+}
+
+TEST_CASE("inplace_overload converts to inplace_function", "[inplace_overload]") {
+    int state = 2;
+    handler_t handler{handler_closure{&state}};
+
+    larid::inplace_function<int(int), 40> f = handler;
+    CHECK(f(3) == 5);
+    CHECK(handler(0) == 5);
+}
+
+TEST_CASE("inplace_overload passes arguments without extra copies", "[inplace_overload]") {
+    larid::inplace_overload<void(counted), void(int)> o = larid::overloaded{[](const counted&) {}, [](int) {}};
+    counted value;
+
+    counted::reset();
+    o(value);
+    CHECK(counted::copies == 1);
+    CHECK(counted::moves == 0);
+
+    counted::reset();
+    o(std::move(value));
+    CHECK(counted::copies == 0);
+    CHECK(counted::moves == 0);
+
+    counted::reset();
+    o(counted{});
+    CHECK(counted::copies == 0);
+    CHECK(counted::moves == 0);
+}
+
+extern "C" {
+void vAssertCalled(const char* file, int line) {
+    std::cerr << "\n[CRITICAL] OS Assert called: " << file << ", line " << line << "\n";
+    std::terminate();
+}
+}  // extern "C"